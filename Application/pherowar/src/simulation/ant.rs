@@ -3,6 +3,7 @@ use super::{
     MAX_PHEROMONE_AMOUNT, SENSE_MAX_ANGLE, SENSE_MAX_DISTANCE, SENSE_NUM_SAMPLES,
     pheromone::PheromoneChannel,
 };
+use super::scheduler::PheromoneWriteLog;
 use super::{MAX_ANT_LONGEVITY, THINK_INTERVAL, Timer};
 use crate::player::PlayerConnection;
 use crate::simulation::{Colony, GameMap, Terrain};
@@ -87,6 +88,7 @@ impl Ant {
         colony_pos: &Vec2,
         map: &mut GameMap,
         pheromones: &mut [PheromoneChannel],
+        write_log: &mut PheromoneWriteLog,
         player_connection: &mut PlayerConnection,
         other_colonies: &mut HashMap<u32, Colony>,
         dt: f32,
@@ -124,6 +126,13 @@ impl Ant {
 
             self.think_timer.wrap();
 
+            // Only observe pending same-tick writes if they fall inside this
+            // ant's sense radius; independent ants perceive the same world
+            // regardless of processing order.
+            if write_log.overlaps_read_set(self.pos) {
+                write_log.flush(pheromones);
+            }
+
             // Perceive the environment
             let (ant_input, perceived) = self.perceive(map, pheromones, colony_pos);
 
@@ -142,8 +151,8 @@ impl Ant {
                 }
             };
 
-            // Apply pheromones
-            self.apply_pheromones(sanitized_ouput.pheromone_amounts, pheromones);
+            // Record pheromones; applied once a dependent ant needs them or at end of tick
+            self.record_pheromones(sanitized_ouput.pheromone_amounts, write_log);
             self.try_attack = sanitized_ouput.try_attack;
             if self.try_attack && !self.is_fighting() {
                 if let Some(mut perceived) = perceived {
@@ -333,17 +342,17 @@ impl Ant {
         Ok(resp.output)
     }
 
-    fn apply_pheromones(
+    fn record_pheromones(
         &mut self,
         pheromones_layed: [f32; PHEROMONE_CHANNEL_COUNT],
-        pheromones_channels: &mut [PheromoneChannel],
+        write_log: &mut PheromoneWriteLog,
     ) {
         let cell_x = self.pos.x.floor() as usize;
         let cell_y = self.pos.y.floor() as usize;
 
         for (idx, &amount) in pheromones_layed.iter().enumerate() {
             if amount > 0.0 && idx < PHEROMONE_CHANNEL_COUNT {
-                pheromones_channels[idx].lay(cell_x, cell_y, amount);
+                write_log.record(cell_x, cell_y, idx, amount);
             }
         }
     }
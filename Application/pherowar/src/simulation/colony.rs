@@ -1,5 +1,6 @@
 use super::ant::{Ant, AntKey};
 use super::pheromone::PheromoneChannel;
+use super::scheduler::PheromoneWriteLog;
 use super::{PHEROMONE_DECAY_INTERVAL, Timer};
 use crate::config::PlayerConfig;
 use crate::player::PlayerConnection;
@@ -22,6 +23,8 @@ pub struct Colony {
     pub player_config: PlayerConfig,
     pub pheromone_decay_timer: Timer,
     pub ant_spawn_timer: f32,
+    /// Per-tick pheromone write log for dependency-tracked scheduling.
+    pheromone_write_log: PheromoneWriteLog,
 }
 
 impl Colony {
@@ -69,6 +72,7 @@ impl Colony {
             player_config: player_cfg,
             pheromone_decay_timer: Timer::new(PHEROMONE_DECAY_INTERVAL, 0.0),
             ant_spawn_timer: 0.0,
+            pheromone_write_log: PheromoneWriteLog::new(),
         })
     }
 
@@ -84,8 +88,12 @@ impl Colony {
             self.pheromone_decay_timer.wrap();
         }
 
-        let (pheromones, player_connection, pos) =
-            (&mut self.pheromones, &mut self.player_connection, self.pos);
+        let (pheromones, player_connection, pos, write_log) = (
+            &mut self.pheromones,
+            &mut self.player_connection,
+            self.pos,
+            &mut self.pheromone_write_log,
+        );
 
         let mut ants_to_despawn: Vec<AntKey> = Vec::new();
 
@@ -115,9 +123,20 @@ impl Colony {
             }
 
             // Updates the ant's position, pheromone laying, and fighting logic
-            ant.update(&pos, map, pheromones, player_connection, other_colonies, dt);
+            ant.update(
+                &pos,
+                map,
+                pheromones,
+                write_log,
+                player_connection,
+                other_colonies,
+                dt,
+            );
         }
 
+        // Make the writes of this tick's independent ants visible before the next tick.
+        write_log.flush(pheromones);
+
         for key in ants_to_despawn {
             self.despawn_ant(key, map);
         }
@@ -3,6 +3,7 @@ mod colony;
 mod map;
 mod pheromone;
 mod raycast;
+mod scheduler;
 mod sim;
 mod timer;
 
@@ -0,0 +1,74 @@
+use macroquad::prelude::Vec2;
+use std::collections::HashSet;
+
+use super::pheromone::PheromoneChannel;
+use shared::PHEROMONE_CHANNEL_COUNT;
+
+/// Side length of a dependency-tracking tile, as a power of two (16 cells).
+/// One tile is larger than SENSE_MAX_DISTANCE (10.0), so an ant's entire read
+/// set (its sense radius) is covered by the 3x3 tile neighborhood around it.
+const TILE_SHIFT: usize = 4;
+
+/// Per-tick log of pheromone writes with tile-granular dependency tracking.
+///
+/// Ants used to lay pheromones directly into the channels as the per-ant loop
+/// advanced, so whether ant B sensed ant A's deposit within the same tick
+/// depended purely on slotmap iteration order — a false dependency for the
+/// (common) case where A and B are nowhere near each other. Think-tick writes
+/// are now recorded here and only flushed into the channels when a later ant's
+/// read set actually overlaps a written tile, or at the end of the colony
+/// update. Ants with disjoint sensory footprints therefore perceive the same
+/// world regardless of processing order, which is also what would let their
+/// brain calls be dispatched concurrently later on.
+pub struct PheromoneWriteLog {
+    /// Recorded writes in arrival order: (x, y, channel, amount).
+    writes: Vec<(usize, usize, usize, f32)>,
+    /// Tiles containing at least one pending write.
+    dirty_tiles: HashSet<(usize, usize)>,
+}
+
+impl PheromoneWriteLog {
+    pub fn new() -> Self {
+        Self {
+            writes: Vec::new(),
+            dirty_tiles: HashSet::new(),
+        }
+    }
+
+    /// Record a pheromone deposit to be applied at the next flush.
+    pub fn record(&mut self, x: usize, y: usize, channel: usize, amount: f32) {
+        if channel < PHEROMONE_CHANNEL_COUNT {
+            self.writes.push((x, y, channel, amount));
+            self.dirty_tiles.insert((x >> TILE_SHIFT, y >> TILE_SHIFT));
+        }
+    }
+
+    /// True if a pending write lies within the read set (sense radius) of an
+    /// ant at `pos`, i.e. the ant must observe earlier writes before sensing.
+    pub fn overlaps_read_set(&self, pos: Vec2) -> bool {
+        if self.dirty_tiles.is_empty() {
+            return false;
+        }
+        let tile_x = (pos.x.floor().max(0.0) as usize) >> TILE_SHIFT;
+        let tile_y = (pos.y.floor().max(0.0) as usize) >> TILE_SHIFT;
+        for dy in -1i64..=1 {
+            for dx in -1i64..=1 {
+                let nx = tile_x as i64 + dx;
+                let ny = tile_y as i64 + dy;
+                if nx >= 0 && ny >= 0 && self.dirty_tiles.contains(&(nx as usize, ny as usize)) {
+                    return true;
+                }
+            }
+        }
+        false
+    }
+
+    /// Apply all pending writes to the channels, in recorded order.
+    pub fn flush(&mut self, channels: &mut [PheromoneChannel]) {
+        for &(x, y, channel, amount) in &self.writes {
+            channels[channel].lay(x, y, amount);
+        }
+        self.writes.clear();
+        self.dirty_tiles.clear();
+    }
+}
@@ -1,67 +1,517 @@
 #include "brain.h"
-#include <stdlib.h>
-#include <time.h>
-#include <string.h>
-#include <math.h>
-#include <stdio.h>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
+#include <stdlib.h> // malloc/free, for the flat-ABI scratch lanes
+#include <time.h>   // time, for PRNG seeding
+#include <string.h> // memset, for the try_attack byte runs
+#include <stdio.h>  // printf, setup greeting and DEBUG_BRAIN trace
+
+#ifdef __AVX2__
+#include <immintrin.h>
 #endif
 
 // Constants from Rust brain (approximated or simplified)
 #define TO_COLONY 0
 #define TO_FOOD 1
 #define BASIC_PHEROMONE_LAYED_AMOUNTY 5.0f // Simplified constant
-#define MAX_TURN_ANGLE (M_PI / 4.0f)
+// Float literal: M_PI is a double, so spelling this as (M_PI / 4.0f) promoted
+// every surrounding float expression to double and back.
+#define MAX_TURN_ANGLE 0.7853981633974483f
+
+// Fixed-point counterparts for the q16 batch (angles Q2.14, amounts/distances Q4.12).
+#define MAX_TURN_ANGLE_Q14 12867              // round(MAX_TURN_ANGLE * (1 << 14))
+#define RAND_TURN_SCALE_Q15 25734             // maps a 15-bit centered uniform onto +/-MAX_TURN_ANGLE_Q14
+#define BASIC_PHEROMONE_LAYED_AMOUNT_Q12 (5 << 12)
+#define ENEMY_CLOSE_DIST_Q12 (5 << 12)
+
+// splitmix64 step, used only to expand one seed into the per-lane PRNG state.
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Per-thread scalar PRNG state for the scalar update path and SIMD-remainder
+// lanes. Replaces the libc rand()/srand() pair: rand() goes through global
+// state (a lock on some platforms) and would serialize threads driving many
+// colonies, while this xorshift is a few registers with no libc dependency.
+static _Thread_local uint64_t scalar_rng_state = 0;
+
+// Scale from the 24-bit PRNG output to the full turn range, precomputed at
+// file scope so the random-turn conversion folds to one multiply-and-subtract
+// (an FMA at -O2) with no division on the hot path.
+static const float kRandTurnScale = (2.0f * MAX_TURN_ANGLE) / (float)(1 << 24);
+
+// The senses this brain actually reads; everything else in AntInput is cold
+// traffic the host may skip filling (see brain.h).
+const uint32_t brain_input_mask =
+    (1u << INPUT_FIELD_IS_CARRYING_FOOD) | (1u << INPUT_FIELD_PHEROMONE_SENSES) |
+    (1u << INPUT_FIELD_FOOD_SENSE) | (1u << INPUT_FIELD_COLONY_SENSE) |
+    (1u << INPUT_FIELD_ENEMY_SENSE);
+
+// One xorshift64 step of the thread-local scalar state.
+static uint64_t scalar_rng_next(void) {
+    if (scalar_rng_state == 0) {
+        // Covers threads that never ran setup (and the zero fixed point).
+        uint64_t seed = (uint64_t)time(NULL);
+        scalar_rng_state = splitmix64(&seed) | 1u;
+    }
+    uint64_t x = scalar_rng_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    scalar_rng_state = x;
+    return x;
+}
+
+// Random turn angle in [-MAX_TURN_ANGLE, MAX_TURN_ANGLE]: top 24 PRNG bits
+// mapped to the turn range with one multiply-and-subtract.
+static float random_turn_angle(void) {
+    return (float)(uint32_t)(scalar_rng_next() >> 40) * kRandTurnScale - MAX_TURN_ANGLE;
+}
+
+#ifdef __AVX2__
+// Per-thread xoshiro128+ state, 8 independent 32-bit streams (one per SIMD lane).
+// Replaces rand() in the batched kernel: rand() serializes on libc global state
+// and yields one value per call, while this produces 8 turn angles per step
+// with a handful of integer ops.
+static _Thread_local __m256i rng_state[4];
+static _Thread_local int rng_seeded = 0;
+
+static void rng_seed(uint64_t seed) {
+    uint32_t lanes[4][8];
+    for (int lane = 0; lane < 8; lane++) {
+        uint64_t s = seed + lane;
+        lanes[0][lane] = (uint32_t)splitmix64(&s);
+        lanes[1][lane] = (uint32_t)splitmix64(&s);
+        lanes[2][lane] = (uint32_t)splitmix64(&s);
+        lanes[3][lane] = (uint32_t)splitmix64(&s);
+    }
+    for (int j = 0; j < 4; j++) {
+        rng_state[j] = _mm256_loadu_si256((const __m256i*)lanes[j]);
+    }
+    rng_seeded = 1;
+}
+
+// One xoshiro128+ step for all 8 lanes, returning the raw 32-bit outputs.
+static __m256i avx2_rng_next(void) {
+    if (!rng_seeded) {
+        // update_batch may run on a thread that never saw setup; seed lazily once.
+        rng_seed((uint64_t)time(NULL));
+    }
+
+    __m256i r = _mm256_add_epi32(rng_state[0], rng_state[3]);
+    __m256i t = _mm256_slli_epi32(rng_state[1], 9);
+    rng_state[2] = _mm256_xor_si256(rng_state[2], rng_state[0]);
+    rng_state[3] = _mm256_xor_si256(rng_state[3], rng_state[1]);
+    rng_state[1] = _mm256_xor_si256(rng_state[1], rng_state[2]);
+    rng_state[0] = _mm256_xor_si256(rng_state[0], rng_state[3]);
+    rng_state[2] = _mm256_xor_si256(rng_state[2], t);
+    rng_state[3] = _mm256_or_si256(_mm256_slli_epi32(rng_state[3], 11),
+                                   _mm256_srli_epi32(rng_state[3], 21));
+    return r;
+}
+
+// Random turn angles for 8 float lanes, in [-MAX_TURN_ANGLE, MAX_TURN_ANGLE].
+static __m256 avx2_random_turn_angles(void) {
+    // Top 23 bits -> float in [0, 2^23), then one scale-and-shift to the turn range.
+    __m256 u = _mm256_cvtepi32_ps(_mm256_srli_epi32(avx2_rng_next(), 9));
+    const __m256 scale = _mm256_set1_ps((2.0f * MAX_TURN_ANGLE) / (float)(1 << 23));
+    const __m256 offset = _mm256_set1_ps(MAX_TURN_ANGLE);
+    return _mm256_sub_ps(_mm256_mul_ps(u, scale), offset);
+}
+#endif
 
 void setup(PlayerSetup* setup) {
-    srand((unsigned)time(NULL));
+    uint64_t seed = (uint64_t)time(NULL);
+    scalar_rng_state = splitmix64(&seed) | 1u;
+#ifdef __AVX2__
+    rng_seed(seed);
+#endif
     setup->decay_rates[TO_COLONY] = 0.99f;
     setup->decay_rates[TO_FOOD] = 0.9f;
     printf("Hello from dummy brain `setup` func\n");
 }
 
-void update(const AntInput* input, uint8_t memory[MEMORY_SIZE], AntOutput* output) {
-    // --- Pheromone Laying Decision ---
-    int pheromone_channel_to_lay = input->is_carrying_food ? TO_FOOD : TO_COLONY;
+// Scalar decision for one lane of the SoA batch. Used for the loop remainder
+// and as the whole batch body when the build has no SIMD target.
+static void update_batch_lane(const AntInputSoA* input, AntOutputSoA* output, size_t i) {
+    float turn_angle;
 
-    // --- Pheromone Amount Calculation ---
-    float layed_pheromone_amount = BASIC_PHEROMONE_LAYED_AMOUNTY;
+    if (input->carrying[i]) {
+        if (input->colony_dist[i] >= 0.0f) {
+            turn_angle = input->colony_angle[i];
+        } else if (input->pher_to_colony_str[i] > 0.0f) {
+            turn_angle = input->pher_to_colony_angle[i];
+        } else {
+            turn_angle = random_turn_angle();
+        }
+        output->pher_to_food_amount[i] = BASIC_PHEROMONE_LAYED_AMOUNTY;
+        output->pher_to_colony_amount[i] = 0.0f;
+    } else {
+        if (input->food_dist[i] >= 0.0f) {
+            turn_angle = input->food_angle[i];
+        } else if (input->pher_to_food_str[i] > 0.0f) {
+            turn_angle = input->pher_to_food_angle[i];
+        } else {
+            turn_angle = random_turn_angle();
+        }
+        output->pher_to_colony_amount[i] = BASIC_PHEROMONE_LAYED_AMOUNTY;
+        output->pher_to_food_amount[i] = 0.0f;
+    }
 
-    // --- Initialize Pheromone Output ---
-    output->pheromone_amounts[pheromone_channel_to_lay] = layed_pheromone_amount;
+    if (input->enemy_dist[i] >= 0.0f && input->enemy_dist[i] < 5.0f) {
+        turn_angle = input->enemy_angle[i];
+    }
 
-    // --- Movement Decision ---
-    float turn_angle;
+    output->turn_angle[i] = turn_angle;
+    output->try_attack[i] = 1;
+}
+
+// Protected visibility: callers inside the library (or statically linked hosts)
+// bind directly instead of going through the PLT on every batch.
+__attribute__((hot, visibility("protected")))
+void update_batch(const AntInputSoA* input, uint8_t (*memories)[MEMORY_SIZE],
+                  AntOutputSoA* output, size_t n) {
+    // The memory blocks are contiguous and MEMORY_SIZE-aligned per the ABI, so
+    // each ant's 32 bytes is one aligned vector load away. This brain keeps no
+    // per-ant state yet, but stating the alignment here lets a stateful
+    // successor read/write memories[i] with vmovdqa for free.
+    memories = __builtin_assume_aligned(memories, MEMORY_SIZE);
+    (void)memories;
+    size_t i = 0;
+
+#ifdef __AVX2__
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 five = _mm256_set1_ps(5.0f);
+    const __m256 lay_amount = _mm256_set1_ps(BASIC_PHEROMONE_LAYED_AMOUNTY);
+
+    // The outputs are written once here and consumed by the simulator in a
+    // separate pass, so caching them only evicts the sense arrays the next
+    // chunk is about to read. Stream them past the cache when the caller gave
+    // us 32-byte aligned output arrays (stream stores require alignment).
+    int stream_ok = (((uintptr_t)output->turn_angle | (uintptr_t)output->pher_to_colony_amount |
+                      (uintptr_t)output->pher_to_food_amount) & 31u) == 0;
+
+    for (; i + 8 <= n; i += 8) {
+        // Random candidates for the lanes whose deterministic senses are all empty.
+        __m256 rand_angle = avx2_random_turn_angles();
+
+        // Carrying branch: colony sense, else to-colony trail, else random.
+        __m256 colony_dist = _mm256_loadu_ps(input->colony_dist + i);
+        __m256 m_colony_valid = _mm256_cmp_ps(colony_dist, zero, _CMP_GE_OQ);
+        __m256 m_pher_colony =
+            _mm256_cmp_ps(_mm256_loadu_ps(input->pher_to_colony_str + i), zero, _CMP_GT_OQ);
+        __m256 angle_carry = _mm256_blendv_ps(
+            rand_angle, _mm256_loadu_ps(input->pher_to_colony_angle + i), m_pher_colony);
+        angle_carry = _mm256_blendv_ps(
+            angle_carry, _mm256_loadu_ps(input->colony_angle + i), m_colony_valid);
+
+        // Foraging branch: food sense, else to-food trail, else random.
+        __m256 food_dist = _mm256_loadu_ps(input->food_dist + i);
+        __m256 m_food_valid = _mm256_cmp_ps(food_dist, zero, _CMP_GE_OQ);
+        __m256 m_pher_food =
+            _mm256_cmp_ps(_mm256_loadu_ps(input->pher_to_food_str + i), zero, _CMP_GT_OQ);
+        __m256 angle_forage = _mm256_blendv_ps(
+            rand_angle, _mm256_loadu_ps(input->pher_to_food_angle + i), m_pher_food);
+        angle_forage = _mm256_blendv_ps(
+            angle_forage, _mm256_loadu_ps(input->food_angle + i), m_food_valid);
+
+        // Select per lane on is_carrying_food (widen the 8 state bytes to lane masks).
+        __m256i carry_u32 =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(input->carrying + i)));
+        __m256 m_carry = _mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(carry_u32, _mm256_setzero_si256()));
+        __m256 turn = _mm256_blendv_ps(angle_forage, angle_carry, m_carry);
+
+        // Enemy within 5 cells overrides the movement decision.
+        __m256 enemy_dist = _mm256_loadu_ps(input->enemy_dist + i);
+        __m256 m_enemy = _mm256_and_ps(
+            _mm256_cmp_ps(enemy_dist, zero, _CMP_GE_OQ),
+            _mm256_cmp_ps(enemy_dist, five, _CMP_LT_OQ));
+        turn = _mm256_blendv_ps(turn, _mm256_loadu_ps(input->enemy_angle + i), m_enemy);
+
+        __m256 food_amount = _mm256_and_ps(m_carry, lay_amount);
+        __m256 colony_amount = _mm256_andnot_ps(m_carry, lay_amount);
+        if (stream_ok) {
+            _mm256_stream_ps(output->turn_angle + i, turn);
+            _mm256_stream_ps(output->pher_to_food_amount + i, food_amount);
+            _mm256_stream_ps(output->pher_to_colony_amount + i, colony_amount);
+        } else {
+            _mm256_storeu_ps(output->turn_angle + i, turn);
+            _mm256_storeu_ps(output->pher_to_food_amount + i, food_amount);
+            _mm256_storeu_ps(output->pher_to_colony_amount + i, colony_amount);
+        }
+        memset(output->try_attack + i, 1, 8);
+    }
+
+    if (stream_ok) {
+        // Order the non-temporal stores before the caller reads the outputs.
+        _mm_sfence();
+    }
+#endif
+
+    for (; i < n; i++) {
+        update_batch_lane(input, output, i);
+    }
+}
+
+// Random turn angle in Q2.14, in [-MAX_TURN_ANGLE_Q14, MAX_TURN_ANGLE_Q14].
+static int16_t random_turn_angle_q16(void) {
+    int32_t u = (int32_t)((scalar_rng_next() >> 33) & 0x7FFF) - 0x4000;
+    return (int16_t)((u * RAND_TURN_SCALE_Q15) >> 15);
+}
+
+// Scalar q16 decision for one lane; loop remainder and non-SIMD builds.
+static void update_batch_q16_lane(const AntInputSoAQ16* input, AntOutputSoAQ16* output, size_t i) {
+    int16_t turn_angle;
 
-    if (input->is_carrying_food) {
-        if (input->colony_sense[1] >= 0.0f) { // Check if distance is valid (not -1.0)
-            turn_angle = input->colony_sense[0]; // Turn towards colony
-        } else if (input->pheromone_senses[TO_COLONY][1] > 0.0f) {
-            turn_angle = input->pheromone_senses[TO_COLONY][0]; // Follow "to colony" trail
+    if (input->carrying[i]) {
+        if (input->colony_dist[i] >= 0) {
+            turn_angle = input->colony_angle[i];
+        } else if (input->pher_to_colony_str[i] > 0) {
+            turn_angle = input->pher_to_colony_angle[i];
         } else {
-            // Random turn
-            turn_angle = ((float)rand() / (float)RAND_MAX) * 2.0f * MAX_TURN_ANGLE - MAX_TURN_ANGLE;
+            turn_angle = random_turn_angle_q16();
         }
-    } else { // Not carrying food
-        if (input->food_sense[1] >= 0.0f) { // Check if distance is valid (not -1.0)
-            turn_angle = input->food_sense[0]; // Turn towards food
-        } else if (input->pheromone_senses[TO_FOOD][1] > 0.0f) {
-            turn_angle = input->pheromone_senses[TO_FOOD][0]; // Follow "to food" trail
+        output->pher_to_food_amount[i] = BASIC_PHEROMONE_LAYED_AMOUNT_Q12;
+        output->pher_to_colony_amount[i] = 0;
+    } else {
+        if (input->food_dist[i] >= 0) {
+            turn_angle = input->food_angle[i];
+        } else if (input->pher_to_food_str[i] > 0) {
+            turn_angle = input->pher_to_food_angle[i];
         } else {
-            // Random turn
-            turn_angle = ((float)rand() / (float)RAND_MAX) * 2.0f * MAX_TURN_ANGLE - MAX_TURN_ANGLE;
+            turn_angle = random_turn_angle_q16();
+        }
+        output->pher_to_colony_amount[i] = BASIC_PHEROMONE_LAYED_AMOUNT_Q12;
+        output->pher_to_food_amount[i] = 0;
+    }
+
+    if (input->enemy_dist[i] >= 0 && input->enemy_dist[i] < ENEMY_CLOSE_DIST_Q12) {
+        turn_angle = input->enemy_angle[i];
+    }
+
+    output->turn_angle[i] = turn_angle;
+    output->try_attack[i] = 1;
+}
+
+void update_batch_q16(const AntInputSoAQ16* input, uint8_t (*memories)[MEMORY_SIZE],
+                      AntOutputSoAQ16* output, size_t n) {
+    memories = __builtin_assume_aligned(memories, MEMORY_SIZE);
+    (void)memories;
+    size_t i = 0;
+
+#ifdef __AVX2__
+    // Same decision tree as update_batch, but on int16 lanes: half the bytes
+    // per sense and 16 ants per 256-bit register instead of 8. blendv_epi8
+    // selects per byte on the mask MSB; the epi16 compares set both bytes of
+    // each lane, so the blends stay lane-exact.
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i enemy_close = _mm256_set1_epi16(ENEMY_CLOSE_DIST_Q12);
+    const __m256i lay_amount = _mm256_set1_epi16(BASIC_PHEROMONE_LAYED_AMOUNT_Q12);
+
+    for (; i + 16 <= n; i += 16) {
+        // 16 random Q2.14 turn angles: 15-bit centered uniform times the Q15 scale.
+        __m256i u = _mm256_sub_epi16(
+            _mm256_and_si256(avx2_rng_next(), _mm256_set1_epi16(0x7FFF)),
+            _mm256_set1_epi16(0x4000));
+        __m256i rand_angle = _mm256_mulhrs_epi16(u, _mm256_set1_epi16(RAND_TURN_SCALE_Q15));
+
+        // Carrying branch: colony sense, else to-colony trail, else random.
+        __m256i m_colony_missing =
+            _mm256_cmpgt_epi16(zero, _mm256_loadu_si256((const __m256i*)(input->colony_dist + i)));
+        __m256i m_pher_colony = _mm256_cmpgt_epi16(
+            _mm256_loadu_si256((const __m256i*)(input->pher_to_colony_str + i)), zero);
+        __m256i carry_fallback = _mm256_blendv_epi8(
+            rand_angle, _mm256_loadu_si256((const __m256i*)(input->pher_to_colony_angle + i)),
+            m_pher_colony);
+        __m256i angle_carry = _mm256_blendv_epi8(
+            _mm256_loadu_si256((const __m256i*)(input->colony_angle + i)), carry_fallback,
+            m_colony_missing);
+
+        // Foraging branch: food sense, else to-food trail, else random.
+        __m256i m_food_missing =
+            _mm256_cmpgt_epi16(zero, _mm256_loadu_si256((const __m256i*)(input->food_dist + i)));
+        __m256i m_pher_food = _mm256_cmpgt_epi16(
+            _mm256_loadu_si256((const __m256i*)(input->pher_to_food_str + i)), zero);
+        __m256i forage_fallback = _mm256_blendv_epi8(
+            rand_angle, _mm256_loadu_si256((const __m256i*)(input->pher_to_food_angle + i)),
+            m_pher_food);
+        __m256i angle_forage = _mm256_blendv_epi8(
+            _mm256_loadu_si256((const __m256i*)(input->food_angle + i)), forage_fallback,
+            m_food_missing);
+
+        // Select per lane on is_carrying_food (widen 16 state bytes to lane masks).
+        __m256i carry16 =
+            _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(input->carrying + i)));
+        __m256i m_carry = _mm256_cmpgt_epi16(carry16, zero);
+        __m256i turn = _mm256_blendv_epi8(angle_forage, angle_carry, m_carry);
+
+        // Enemy within 5 cells overrides the movement decision.
+        __m256i enemy_dist = _mm256_loadu_si256((const __m256i*)(input->enemy_dist + i));
+        __m256i m_enemy = _mm256_andnot_si256(
+            _mm256_cmpgt_epi16(zero, enemy_dist), _mm256_cmpgt_epi16(enemy_close, enemy_dist));
+        turn = _mm256_blendv_epi8(
+            turn, _mm256_loadu_si256((const __m256i*)(input->enemy_angle + i)), m_enemy);
+
+        _mm256_storeu_si256((__m256i*)(output->turn_angle + i), turn);
+        _mm256_storeu_si256((__m256i*)(output->pher_to_food_amount + i),
+                            _mm256_and_si256(m_carry, lay_amount));
+        _mm256_storeu_si256((__m256i*)(output->pher_to_colony_amount + i),
+                            _mm256_andnot_si256(m_carry, lay_amount));
+        memset(output->try_attack + i, 1, 16);
+    }
+#endif
+
+    for (; i < n; i++) {
+        update_batch_q16_lane(input, output, i);
+    }
+}
+
+// Flat-array entry point for foreign callers; see brain.h for the buffer
+// layout. Only the boolean lanes need translating between the float buffers a
+// NumPy driver naturally holds and the uint8 lanes update_batch works on.
+void update_batch_flat(const float* input_soa, uint8_t* memories, float* output_soa, int n) {
+    if (n <= 0) {
+        return;
+    }
+    size_t count = (size_t)n;
+
+    // Thread-local scratch for the carrying/try_attack byte lanes, grown once
+    // and reused across ticks.
+    static _Thread_local uint8_t* scratch = NULL;
+    static _Thread_local size_t scratch_cap = 0;
+    if (count * 2 > scratch_cap) {
+        free(scratch);
+        scratch = malloc(count * 2);
+        if (scratch == NULL) {
+            scratch_cap = 0;
+            return;
         }
+        scratch_cap = count * 2;
     }
+    uint8_t* carrying = scratch;
+    uint8_t* try_attack = scratch + count;
 
-    output->turn_angle = turn_angle;
+    for (size_t i = 0; i < count; i++) {
+        carrying[i] = input_soa[10 * count + i] != 0.0f;
+    }
+
+    AntInputSoA input = {
+        input_soa + 0 * count, input_soa + 1 * count, // colony angle, dist
+        input_soa + 2 * count, input_soa + 3 * count, // food angle, dist
+        input_soa + 4 * count, input_soa + 5 * count, // to-colony trail angle, strength
+        input_soa + 6 * count, input_soa + 7 * count, // to-food trail angle, strength
+        input_soa + 8 * count, input_soa + 9 * count, // enemy angle, dist
+        carrying,
+    };
+    AntOutputSoA output = {
+        output_soa + 0 * count, // turn_angle
+        output_soa + 1 * count, // pher_to_colony_amount
+        output_soa + 2 * count, // pher_to_food_amount
+        try_attack,
+    };
+
+    update_batch(&input, (uint8_t (*)[MEMORY_SIZE])memories, &output, count);
+
+    for (size_t i = 0; i < count; i++) {
+        output_soa[3 * count + i] = (float)try_attack[i];
+    }
+}
+
+// Out-of-line tail for the rare close-enemy case, so the hot straight-line
+// body of the update specializations stays compact in the I-cache.
+__attribute__((cold, noinline))
+static float handle_enemy(const AntInput* input) {
+#ifdef DEBUG_BRAIN
+    // printf takes a global FILE lock and formats two floats; keep it out of
+    // release builds since the enemy branch is the hottest path for fighters.
+    printf("Enemy detected at angle: %f, distance: %f\n", input->enemy_sense[0], input->enemy_sense[1]);
+#endif
+    return input->enemy_sense[0];
+}
+
+// Overrides the movement decision when an enemy is within 5 cells; shared by
+// both update specializations. Most ants have no enemy nearby, so the branch
+// is predicted-not-taken and the override body lives in cold text.
+static float enemy_override(const AntInput* input, float turn_angle) {
+    if (__builtin_expect(input->enemy_sense[1] >= 0.0f && input->enemy_sense[1] < 5.0f, 0)) {
+        return handle_enemy(input);
+    }
+    return turn_angle;
+}
+
+// update split into per-state specializations: is_carrying_food is ant state
+// that holds for many consecutive think ticks, so each ant keeps re-running
+// the same half of the function. A direct table dispatch on the flag keeps the
+// per-state code half the size and lets the branch predictor settle per path.
 
-    // If an enemy is detected within 5 cells
-    if (input->enemy_sense[1] >= 0.0f && input->enemy_sense[1] < 5.0f) {
-        printf("Enemy detected at angle: %f, distance: %f\n", input->enemy_sense[0], input->enemy_sense[1]);
-        output->turn_angle = input->enemy_sense[0]; // Turn towards enemy
-    } 
-    
+// Carrying: towards colony, else along the "to colony" trail, else random.
+static void update_carrying(const AntInput* input, uint8_t memory[MEMORY_SIZE], AntOutput* output) {
+    (void)memory;
+    int sense_valid = input->colony_sense[1] >= 0.0f;
+    int pher_present = input->pheromone_senses[TO_COLONY][1] > 0.0f;
+
+    // Decision table indexed by (sense_valid << 1) | pher_present: the two
+    // dependent selects become one AND-OR index and one load.
+    float candidates[4] = {
+        random_turn_angle(),                     // !sense_valid, !pher_present
+        input->pheromone_senses[TO_COLONY][0],   // !sense_valid,  pher_present
+        input->colony_sense[0],                  //  sense_valid, !pher_present
+        input->colony_sense[0],                  //  sense_valid,  pher_present
+    };
+    float turn_angle = candidates[(sense_valid << 1) | pher_present];
+
+    // All 8 channels in one 32-byte store: zeroes plus the one channel laid,
+    // so the host never needs to re-zero the array. AntOutput's layout is
+    // fixed by the engine ABI (the array sits at offset 4), hence the
+    // unaligned store rather than an aligned member.
+#ifdef __AVX2__
+    _mm256_storeu_ps(output->pheromone_amounts,
+                     _mm256_blend_ps(_mm256_setzero_ps(),
+                                     _mm256_set1_ps(BASIC_PHEROMONE_LAYED_AMOUNTY), 1 << TO_FOOD));
+#else
+    memset(output->pheromone_amounts, 0, sizeof(output->pheromone_amounts));
+    output->pheromone_amounts[TO_FOOD] = BASIC_PHEROMONE_LAYED_AMOUNTY;
+#endif
+    output->turn_angle = enemy_override(input, turn_angle);
     output->try_attack = true;
 }
+
+// Foraging: towards food, else along the "to food" trail, else random.
+static void update_foraging(const AntInput* input, uint8_t memory[MEMORY_SIZE], AntOutput* output) {
+    (void)memory;
+    int sense_valid = input->food_sense[1] >= 0.0f;
+    int pher_present = input->pheromone_senses[TO_FOOD][1] > 0.0f;
+
+    // Same decision table as update_carrying, with the food channel sources.
+    float candidates[4] = {
+        random_turn_angle(),                   // !sense_valid, !pher_present
+        input->pheromone_senses[TO_FOOD][0],   // !sense_valid,  pher_present
+        input->food_sense[0],                  //  sense_valid, !pher_present
+        input->food_sense[0],                  //  sense_valid,  pher_present
+    };
+    float turn_angle = candidates[(sense_valid << 1) | pher_present];
+
+    // Single 32-byte store of the full channel array, as in update_carrying.
+#ifdef __AVX2__
+    _mm256_storeu_ps(output->pheromone_amounts,
+                     _mm256_blend_ps(_mm256_setzero_ps(),
+                                     _mm256_set1_ps(BASIC_PHEROMONE_LAYED_AMOUNTY), 1 << TO_COLONY));
+#else
+    memset(output->pheromone_amounts, 0, sizeof(output->pheromone_amounts));
+    output->pheromone_amounts[TO_COLONY] = BASIC_PHEROMONE_LAYED_AMOUNTY;
+#endif
+    output->turn_angle = enemy_override(input, turn_angle);
+    output->try_attack = true;
+}
+
+typedef void (*brain_fn)(const AntInput*, uint8_t*, AntOutput*);
+static const brain_fn kUpdateByState[2] = { update_foraging, update_carrying };
+
+// hot keeps the per-ant entry point grouped with the rest of the hot text;
+// flatten inlines the specializations so the dispatch is the only call left.
+__attribute__((hot, flatten))
+void update(const AntInput* input, uint8_t memory[MEMORY_SIZE], AntOutput* output) {
+    kUpdateByState[input->is_carrying_food != 0](input, memory, output);
+}
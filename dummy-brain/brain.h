@@ -5,6 +5,7 @@
 
 #include <stdint.h> // For uint8_t
 #include <stdbool.h>  // For bool type
+#include <stddef.h> // For size_t
 
 // Defines the size in bytes of the persistent memory block available to each individual ant.
 // Each ant has its own dedicated memory array of this size. This memory persists across
@@ -129,6 +130,130 @@ typedef struct {
 //               The game engine will use these modified values.
 void setup(PlayerSetup* setup_info);
 
+// AntInputSoA:
+// Structure-of-arrays view of the sensory data for a whole batch of ants.
+// Each pointer refers to an array of `n` values (one per ant), where `n` is the
+// batch size passed to update_batch. Splitting the hot senses into parallel arrays
+// lets the batched update process 8+ ants per instruction with SIMD instead of
+// chasing one AntInput pointer per ant.
+// Angle/distance conventions are identical to the corresponding AntInput fields
+// (distances are -1.0 when nothing is sensed, pheromone strengths are 0.0 when absent).
+typedef struct {
+    const float* colony_angle;         // colony_sense[0] per ant
+    const float* colony_dist;          // colony_sense[1] per ant
+    const float* food_angle;           // food_sense[0] per ant
+    const float* food_dist;            // food_sense[1] per ant
+    const float* pher_to_colony_angle; // pheromone_senses[TO_COLONY][0] per ant
+    const float* pher_to_colony_str;   // pheromone_senses[TO_COLONY][1] per ant
+    const float* pher_to_food_angle;   // pheromone_senses[TO_FOOD][0] per ant
+    const float* pher_to_food_str;     // pheromone_senses[TO_FOOD][1] per ant
+    const float* enemy_angle;          // enemy_sense[0] per ant
+    const float* enemy_dist;           // enemy_sense[1] per ant
+    const uint8_t* carrying;           // is_carrying_food per ant (0 or 1)
+} AntInputSoA;
+
+// AntOutputSoA:
+// Structure-of-arrays view of the actions for a whole batch of ants.
+// Each pointer refers to an array of `n` values that update_batch fills in,
+// mirroring the AntOutput fields the scalar brain writes.
+// Allocating the float arrays with 32-byte alignment lets the SIMD path use
+// non-temporal stores, keeping the cache free for the input sense arrays;
+// unaligned arrays still work and just take regular stores.
+typedef struct {
+    float* turn_angle;             // desired relative turn per ant (radians)
+    float* pher_to_colony_amount;  // pheromone_amounts[TO_COLONY] per ant
+    float* pher_to_food_amount;    // pheromone_amounts[TO_FOOD] per ant
+    uint8_t* try_attack;           // attack intent per ant (0 or 1)
+} AntOutputSoA;
+
+// update_batch:
+// Batched equivalent of update: makes the same decision for `n` ants in one call.
+// The decision tree is evaluated with masked selects over SIMD lanes where the
+// compiler target supports it (AVX2), with a scalar fallback for the remainder
+// and for non-SIMD builds. `memories` points to `n` contiguous MEMORY_SIZE-byte
+// blocks (ant i's memory is memories[i]); the caller must allocate the block
+// array with MEMORY_SIZE-byte alignment so each ant's memory can be loaded
+// with a single aligned 32-byte SIMD access.
+void update_batch(const AntInputSoA* input, uint8_t (*memories)[MEMORY_SIZE],
+                  AntOutputSoA* output, size_t n);
+
+// AntInputField:
+// Bit positions, one per AntInput field, for the brain_input_mask export below.
+typedef enum {
+    INPUT_FIELD_IS_CARRYING_FOOD = 0,
+    INPUT_FIELD_IS_ON_COLONY = 1,
+    INPUT_FIELD_IS_ON_FOOD = 2,
+    INPUT_FIELD_PHEROMONE_SENSES = 3,
+    INPUT_FIELD_CELL_SENSE = 4,
+    INPUT_FIELD_WALL_SENSE = 5,
+    INPUT_FIELD_FOOD_SENSE = 6,
+    INPUT_FIELD_COLONY_SENSE = 7,
+    INPUT_FIELD_ENEMY_SENSE = 8,
+    INPUT_FIELD_LONGEVITY = 9,
+    INPUT_FIELD_IS_FIGHTING = 10,
+} AntInputField;
+
+// brain_input_mask:
+// Optional export advertising which AntInput fields this brain actually reads,
+// as an OR of (1 << AntInputField) bits. AntInput is ~190 bytes but a simple
+// brain may read well under half of it; a host that looks this symbol up may
+// skip gathering and filling the unread fields (leaving them zeroed) so each
+// think tick moves only the bytes the brain will consume. Hosts that do not
+// know the symbol keep filling every field, so exporting it is always safe.
+extern const uint32_t brain_input_mask;
+
+// Quantized batch variants of the SoA views above, for hosts that keep their
+// agent arrays in int16 fixed point to halve memory traffic and double the
+// SIMD lane count (16 ants per 256-bit register instead of 8).
+// Formats: angles are Q2.14 (1.0 == 1<<14, covering [-pi, pi] comfortably),
+// distances and pheromone strengths are Q4.12 (1.0 == 1<<12). Sentinels carry
+// over from the float ABI: negative distance means "nothing sensed", strength
+// 0 means "no signal".
+typedef struct {
+    const int16_t* colony_angle;         // Q2.14
+    const int16_t* colony_dist;          // Q4.12, negative when not sensed
+    const int16_t* food_angle;           // Q2.14
+    const int16_t* food_dist;            // Q4.12, negative when not sensed
+    const int16_t* pher_to_colony_angle; // Q2.14
+    const int16_t* pher_to_colony_str;   // Q4.12
+    const int16_t* pher_to_food_angle;   // Q2.14
+    const int16_t* pher_to_food_str;     // Q4.12
+    const int16_t* enemy_angle;          // Q2.14
+    const int16_t* enemy_dist;           // Q4.12, negative when not sensed
+    const uint8_t* carrying;             // is_carrying_food per ant (0 or 1)
+} AntInputSoAQ16;
+
+typedef struct {
+    int16_t* turn_angle;            // Q2.14
+    int16_t* pher_to_colony_amount; // Q4.12
+    int16_t* pher_to_food_amount;   // Q4.12
+    uint8_t* try_attack;            // 0 or 1
+} AntOutputSoAQ16;
+
+// update_batch_q16:
+// Same decision as update_batch, evaluated entirely in int16 fixed point.
+// Memory layout and alignment contract for `memories` match update_batch.
+void update_batch_q16(const AntInputSoAQ16* input, uint8_t (*memories)[MEMORY_SIZE],
+                      AntOutputSoAQ16* output, size_t n);
+
+// update_batch_flat:
+// Flat-array wrapper around update_batch with a stable C ABI for foreign
+// callers (ctypes/cffi/NumPy): one call per tick over contiguous float
+// buffers replaces n per-ant transitions.
+// `input_soa` holds 11 arrays of n floats, back to back:
+//   input_soa +  0*n : colony_angle          input_soa +  1*n : colony_dist
+//   input_soa +  2*n : food_angle            input_soa +  3*n : food_dist
+//   input_soa +  4*n : pher_to_colony_angle  input_soa +  5*n : pher_to_colony_str
+//   input_soa +  6*n : pher_to_food_angle    input_soa +  7*n : pher_to_food_str
+//   input_soa +  8*n : enemy_angle           input_soa +  9*n : enemy_dist
+//   input_soa + 10*n : is_carrying_food (0.0 or non-zero)
+// `output_soa` receives 4 arrays of n floats, back to back:
+//   output_soa + 0*n : turn_angle            output_soa + 1*n : pher_to_colony_amount
+//   output_soa + 2*n : pher_to_food_amount   output_soa + 3*n : try_attack (0.0 or 1.0)
+// `memories` follows the update_batch contract (n contiguous MEMORY_SIZE-byte
+// blocks, MEMORY_SIZE-aligned).
+void update_batch_flat(const float* input_soa, uint8_t* memories, float* output_soa, int n);
+
 // update:
 // The core decision-making function for an individual ant.
 // This function is called repeatedly by the game engine for each ant belonging to the player's
@@ -0,0 +1,121 @@
+// CUDA backend for the batched brain update.
+// Built only by the optional `make cuda` target (compiled with -DPHEROWAR_CUDA);
+// the regular brain.so keeps the AVX2/scalar path from brain.c. For colonies with
+// thousands of ants the per-ant decision is embarrassingly parallel: one GPU
+// thread per ant, with coalesced loads over the same SoA layout as update_batch.
+#ifdef PHEROWAR_CUDA
+
+#include "brain.h"
+#include <cuda_runtime.h>
+#include <curand_kernel.h>
+
+// Constants from Rust brain (approximated or simplified), same as brain.c
+#define BASIC_PHEROMONE_LAYED_AMOUNTY 5.0f
+#define MAX_TURN_ANGLE 0.78539816f // PI / 4
+
+#define THREADS_PER_BLOCK 256
+
+// One Philox stream per ant slot for the random-turn branch.
+__global__ void init_rng_kernel(curandStatePhilox4_32_10_t* states, unsigned long long seed, int n) {
+    int tid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (tid < n) {
+        curand_init(seed, tid, 0, &states[tid]);
+    }
+}
+
+// Per-ant decision, identical to the branchless host kernel: each ternary
+// compiles to a predicated select (selp.f32), so warps stay convergent even
+// though ants are in different states.
+__global__ void update_kernel(AntInputSoA input, uint8_t* memories, AntOutputSoA output,
+                              curandStatePhilox4_32_10_t* rng, int n) {
+    int tid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (tid >= n) return;
+    (void)memories; // Persistent per-ant memory stays resident on device; unused by this brain.
+
+    float rand_angle = curand_uniform(&rng[tid]) * 2.0f * MAX_TURN_ANGLE - MAX_TURN_ANGLE;
+
+    // Carrying: towards colony, else along the "to colony" trail, else random.
+    float angle_carry = input.pher_to_colony_str[tid] > 0.0f ? input.pher_to_colony_angle[tid] : rand_angle;
+    angle_carry = input.colony_dist[tid] >= 0.0f ? input.colony_angle[tid] : angle_carry;
+
+    // Foraging: towards food, else along the "to food" trail, else random.
+    float angle_forage = input.pher_to_food_str[tid] > 0.0f ? input.pher_to_food_angle[tid] : rand_angle;
+    angle_forage = input.food_dist[tid] >= 0.0f ? input.food_angle[tid] : angle_forage;
+
+    bool carrying = input.carrying[tid] != 0;
+    float turn = carrying ? angle_carry : angle_forage;
+
+    // Enemy within 5 cells overrides the movement decision.
+    float enemy_dist = input.enemy_dist[tid];
+    turn = (enemy_dist >= 0.0f && enemy_dist < 5.0f) ? input.enemy_angle[tid] : turn;
+
+    output.turn_angle[tid] = turn;
+    output.pher_to_food_amount[tid] = carrying ? BASIC_PHEROMONE_LAYED_AMOUNTY : 0.0f;
+    output.pher_to_colony_amount[tid] = carrying ? 0.0f : BASIC_PHEROMONE_LAYED_AMOUNTY;
+    output.try_attack[tid] = 1;
+}
+
+// Host-side driver: keeps device buffers (including the persistent per-ant
+// memory blocks) resident between ticks, uploads the input SoA arrays, runs the
+// kernel, and downloads the outputs. Grows its buffers when the colony does.
+extern "C" void update_batch_cuda(const AntInputSoA* input, uint8_t* memories,
+                                  AntOutputSoA* output, size_t n) {
+    static float* d_in = NULL;        // 10 input arrays packed back to back
+    static uint8_t* d_carrying = NULL;
+    static float* d_out = NULL;       // 3 output arrays packed back to back
+    static uint8_t* d_try_attack = NULL;
+    static uint8_t* d_memories = NULL;
+    static curandStatePhilox4_32_10_t* d_rng = NULL;
+    static size_t capacity = 0;
+
+    if (n == 0) return;
+
+    if (n > capacity) {
+        cudaFree(d_in);
+        cudaFree(d_carrying);
+        cudaFree(d_out);
+        cudaFree(d_try_attack);
+        cudaFree(d_memories);
+        cudaFree(d_rng);
+        cudaMalloc(&d_in, 10 * n * sizeof(float));
+        cudaMalloc(&d_carrying, n);
+        cudaMalloc(&d_out, 3 * n * sizeof(float));
+        cudaMalloc(&d_try_attack, n);
+        cudaMalloc(&d_memories, n * MEMORY_SIZE);
+        cudaMalloc(&d_rng, n * sizeof(curandStatePhilox4_32_10_t));
+        cudaMemcpy(d_memories, memories, n * MEMORY_SIZE, cudaMemcpyHostToDevice);
+        int blocks = (int)((n + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+        init_rng_kernel<<<blocks, THREADS_PER_BLOCK>>>(d_rng, (unsigned long long)clock(), (int)n);
+        capacity = n;
+    }
+
+    const float* host_in[10] = {
+        input->colony_angle, input->colony_dist,
+        input->food_angle, input->food_dist,
+        input->pher_to_colony_angle, input->pher_to_colony_str,
+        input->pher_to_food_angle, input->pher_to_food_str,
+        input->enemy_angle, input->enemy_dist,
+    };
+    for (int j = 0; j < 10; j++) {
+        cudaMemcpyAsync(d_in + j * n, host_in[j], n * sizeof(float), cudaMemcpyHostToDevice);
+    }
+    cudaMemcpyAsync(d_carrying, input->carrying, n, cudaMemcpyHostToDevice);
+
+    AntInputSoA d_input = {
+        d_in + 0 * n, d_in + 1 * n, d_in + 2 * n, d_in + 3 * n, d_in + 4 * n,
+        d_in + 5 * n, d_in + 6 * n, d_in + 7 * n, d_in + 8 * n, d_in + 9 * n,
+        d_carrying,
+    };
+    AntOutputSoA d_output = { d_out + 0 * n, d_out + 1 * n, d_out + 2 * n, d_try_attack };
+
+    int blocks = (int)((n + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+    update_kernel<<<blocks, THREADS_PER_BLOCK>>>(d_input, d_memories, d_output, d_rng, (int)n);
+
+    cudaMemcpyAsync(output->turn_angle, d_out + 0 * n, n * sizeof(float), cudaMemcpyDeviceToHost);
+    cudaMemcpyAsync(output->pher_to_colony_amount, d_out + 1 * n, n * sizeof(float), cudaMemcpyDeviceToHost);
+    cudaMemcpyAsync(output->pher_to_food_amount, d_out + 2 * n, n * sizeof(float), cudaMemcpyDeviceToHost);
+    cudaMemcpyAsync(output->try_attack, d_try_attack, n, cudaMemcpyDeviceToHost);
+    cudaDeviceSynchronize();
+}
+
+#endif // PHEROWAR_CUDA